@@ -0,0 +1,462 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "Team.h"
+
+// Архив сезонов хранит счетчики команд по столбцам, а не построчно, как football_database.txt.
+// Названия команд вынесены в общий словарь, в сезоне хранятся только их номера.
+//
+// Формат файла (целые числа в порядке байтов little-endian):
+//   "FBAR", версия (uint32)
+//   количество названий (uint32), затем для каждого: длина (uint16) и байты названия
+//   количество сезонов (uint32), затем для каждого сезона:
+//     длина метки (uint16) и байты метки, количество строк (uint32),
+//     описатели столбцов TEAM, WINS, DRAWS, LOSSES: смещение (uint64), база (uint32),
+//     разрядность (uint8), количество слов (uint32)
+//   данные столбцов - упакованные 64-битные слова
+//
+// Столбец TEAM отсортирован и хранится разностями соседних номеров, все столбцы упакованы
+// с вычитанием минимума (база) до разрядности максимального значения. Количество игр
+// не хранится: оно равно сумме побед, ничьих и поражений.
+
+// Столбцы архива
+enum ArchiveColumn {
+    COLUMN_TEAM = 0,
+    COLUMN_WINS = 1,
+    COLUMN_DRAWS = 2,
+    COLUMN_LOSSES = 3,
+    COLUMN_COUNT = 4
+};
+
+// Маски столбцов, которые нужны запросу
+const unsigned int NEED_TEAM = 1u << COLUMN_TEAM;
+const unsigned int NEED_WINS = 1u << COLUMN_WINS;
+const unsigned int NEED_DRAWS = 1u << COLUMN_DRAWS;
+const unsigned int NEED_LOSSES = 1u << COLUMN_LOSSES;
+
+// Количество строк, распаковываемых за один проход ядра
+const size_t ARCHIVE_BLOCK_SIZE = 128;
+
+// Упакованный столбец одного сезона
+struct PackedColumn {
+    uint64_t offset = 0;          // Смещение данных столбца в файле
+    uint32_t base = 0;            // Минимальное значение столбца
+    uint8_t bits = 0;             // Разрядность упакованных значений
+    std::vector<uint64_t> words;  // Упакованные значения (при чтении загружаются по запросу)
+    uint32_t wordCount = 0;       // Количество слов данных
+};
+
+// Описание сезона в архиве
+struct ArchiveSeason {
+    std::string label;            // Метка сезона (например, "2023/24")
+    uint32_t rows = 0;            // Количество команд в сезоне
+    PackedColumn columns[COLUMN_COUNT];
+};
+
+// Итоги клуба по всем сезонам архива
+struct ClubSummary {
+    unsigned int seasons = 0;
+    unsigned long long games = 0;
+    unsigned long long wins = 0;
+    unsigned long long draws = 0;
+    unsigned long long losses = 0;
+    unsigned long long points = 0;
+    int bestSeason = -1;          // Номер сезона с наибольшим количеством очков
+    unsigned int bestPoints = 0;
+    int worstSeason = -1;         // Номер сезона с наименьшим количеством очков
+    unsigned int worstPoints = 0;
+};
+
+// Итоги одного сезона
+struct SeasonSummary {
+    unsigned int teams = 0;
+    unsigned long long games = 0;   // Количество сыгранных матчей (каждый матч учтен один раз)
+    unsigned long long wins = 0;
+    unsigned long long draws = 0;
+    unsigned long long points = 0;
+};
+
+// Разрядность, необходимая для хранения значения
+inline uint8_t bitWidth(uint32_t value) {
+    uint8_t bits = 0;
+    while (value) {
+        bits++;
+        value >>= 1;
+    }
+    return bits;
+}
+
+// Упаковка значений с вычитанием минимума
+inline void packColumn(const std::vector<uint32_t>& values, PackedColumn& column) {
+    column.base = values.empty() ? 0 : *std::min_element(values.begin(), values.end());
+    uint32_t maxDelta = 0;
+    for (uint32_t v : values) {
+        maxDelta = std::max(maxDelta, v - column.base);
+    }
+    column.bits = bitWidth(maxDelta);
+    column.words.assign((values.size() * column.bits + 63) / 64, 0);
+
+    for (size_t i = 0; i < values.size() && column.bits > 0; ++i) {
+        uint64_t v = values[i] - column.base;
+        size_t bit = i * column.bits;
+        size_t word = bit >> 6;
+        size_t shift = bit & 63;
+        column.words[word] |= v << shift;
+        if (shift + column.bits > 64) {
+            column.words[word + 1] |= v >> (64 - shift);
+        }
+    }
+    column.wordCount = static_cast<uint32_t>(column.words.size());
+}
+
+// Распаковка count значений, начиная со строки first
+inline void unpackColumn(const PackedColumn& column, size_t first, size_t count, uint32_t* out) {
+    if (column.bits == 0) {
+        std::fill(out, out + count, column.base);
+        return;
+    }
+
+    const uint64_t mask = (1ULL << column.bits) - 1;
+    const uint64_t* words = column.words.data();
+    for (size_t i = 0; i < count; ++i) {
+        size_t bit = (first + i) * column.bits;
+        size_t word = bit >> 6;
+        size_t shift = bit & 63;
+        uint64_t v = words[word] >> shift;
+        if (shift + column.bits > 64) {
+            v |= words[word + 1] << (64 - shift);
+        }
+        out[i] = column.base + static_cast<uint32_t>(v & mask);
+    }
+}
+
+// Ядра обработки распакованных блоков. Циклы без ветвлений и зависимостей между
+// итерациями, поэтому компилятор векторизует их при включенной оптимизации
+
+// Сумма значений блока
+inline unsigned long long sumKernel(const uint32_t* values, size_t count) {
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+// Очки команд блока (победа = 3 очка, ничья = 1 очко)
+inline void pointsKernel(const uint32_t* wins, const uint32_t* draws, uint32_t* points, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        points[i] = wins[i] * 3 + draws[i];
+    }
+}
+
+// Восстановление номеров команд из разностей (carry - номер последней команды предыдущего блока)
+inline void prefixSumKernel(uint32_t* values, size_t count, uint32_t& carry) {
+    for (size_t i = 0; i < count; ++i) {
+        carry += values[i];
+        values[i] = carry;
+    }
+}
+
+// Запись и чтение целых чисел фиксированного размера
+template <typename T>
+void writeValue(std::ostream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+inline void writeString(std::ostream& out, const std::string& str) {
+    writeValue<uint16_t>(out, static_cast<uint16_t>(str.size()));
+    out.write(str.data(), str.size());
+}
+
+inline bool readString(std::istream& in, std::string& str) {
+    uint16_t length;
+    if (!readValue(in, length)) return false;
+    str.resize(length);
+    return length == 0 || static_cast<bool>(in.read(&str[0], length));
+}
+
+const char ARCHIVE_MAGIC[4] = { 'F', 'B', 'A', 'R' };
+const uint32_t ARCHIVE_VERSION = 1;
+
+// Минимальный размер описания сезона: длина метки, количество строк и описатели столбцов
+const uint64_t SEASON_HEADER_MIN_SIZE = sizeof(uint16_t) + sizeof(uint32_t) +
+    COLUMN_COUNT * (sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint32_t));
+
+// Запись архива из таблиц сезонов
+inline bool writeSeasonArchive(const std::string& filename,
+                               const std::vector<std::string>& labels,
+                               const std::vector<std::vector<Team>>& seasons) {
+    // Общий словарь названий, отсортированный по алфавиту
+    std::vector<std::string> dictionary;
+    for (const auto& season : seasons) {
+        for (const auto& team : season) {
+            dictionary.push_back(team.getName());
+        }
+    }
+    std::sort(dictionary.begin(), dictionary.end());
+    dictionary.erase(std::unique(dictionary.begin(), dictionary.end()), dictionary.end());
+
+    // Разбиение сезонов на столбцы
+    std::vector<ArchiveSeason> packed(seasons.size());
+    for (size_t s = 0; s < seasons.size(); ++s) {
+        std::vector<const Team*> rows;
+        for (const auto& team : seasons[s]) {
+            rows.push_back(&team);
+        }
+
+        std::vector<uint32_t> ids;
+        for (const Team* team : rows) {
+            ids.push_back(static_cast<uint32_t>(std::lower_bound(dictionary.begin(), dictionary.end(),
+                team->getName()) - dictionary.begin()));
+        }
+
+        // Строки упорядочиваются по номеру команды, чтобы разности номеров были малы
+        std::vector<size_t> order(rows.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return ids[a] < ids[b]; });
+
+        std::vector<uint32_t> teamColumn, winsColumn, drawsColumn, lossesColumn;
+        uint32_t previous = 0;
+        for (size_t i : order) {
+            teamColumn.push_back(ids[i] - previous);
+            previous = ids[i];
+            winsColumn.push_back(rows[i]->getWins());
+            drawsColumn.push_back(rows[i]->getDraws());
+            lossesColumn.push_back(rows[i]->getLosses());
+        }
+
+        packed[s].label = labels[s];
+        packed[s].rows = static_cast<uint32_t>(rows.size());
+        packColumn(teamColumn, packed[s].columns[COLUMN_TEAM]);
+        packColumn(winsColumn, packed[s].columns[COLUMN_WINS]);
+        packColumn(drawsColumn, packed[s].columns[COLUMN_DRAWS]);
+        packColumn(lossesColumn, packed[s].columns[COLUMN_LOSSES]);
+    }
+
+    // Размер заголовка нужен заранее, чтобы записать смещения столбцов
+    uint64_t offset = sizeof(ARCHIVE_MAGIC) + sizeof(uint32_t) + sizeof(uint32_t);
+    for (const auto& name : dictionary) {
+        offset += sizeof(uint16_t) + name.size();
+    }
+    offset += sizeof(uint32_t);
+    for (const auto& season : packed) {
+        offset += sizeof(uint16_t) + season.label.size() + sizeof(uint32_t);
+        offset += COLUMN_COUNT * (sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint32_t));
+    }
+    for (auto& season : packed) {
+        for (auto& column : season.columns) {
+            column.offset = offset;
+            offset += column.words.size() * sizeof(uint64_t);
+        }
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    file.write(ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC));
+    writeValue(file, ARCHIVE_VERSION);
+    writeValue<uint32_t>(file, static_cast<uint32_t>(dictionary.size()));
+    for (const auto& name : dictionary) {
+        writeString(file, name);
+    }
+    writeValue<uint32_t>(file, static_cast<uint32_t>(packed.size()));
+    for (const auto& season : packed) {
+        writeString(file, season.label);
+        writeValue(file, season.rows);
+        for (const auto& column : season.columns) {
+            writeValue(file, column.offset);
+            writeValue(file, column.base);
+            writeValue(file, column.bits);
+            writeValue(file, column.wordCount);
+        }
+    }
+    for (const auto& season : packed) {
+        for (const auto& column : season.columns) {
+            file.write(reinterpret_cast<const char*>(column.words.data()),
+                       column.words.size() * sizeof(uint64_t));
+        }
+    }
+    return static_cast<bool>(file);
+}
+
+// Чтение архива и выполнение запросов.
+// При открытии читаются только словарь и описатели столбцов; данные столбцов
+// загружаются с диска лишь тогда, когда они нужны запросу
+class SeasonArchive {
+private:
+    std::ifstream file;
+    std::vector<std::string> names;
+    std::vector<ArchiveSeason> seasons;
+
+    // Загрузка нужных запросу столбцов сезона и освобождение остальных
+    bool loadColumns(ArchiveSeason& season, unsigned int needed) {
+        for (int c = 0; c < COLUMN_COUNT; ++c) {
+            PackedColumn& column = season.columns[c];
+            if (!(needed & (1u << c))) {
+                column.words.clear();
+                continue;
+            }
+            column.words.resize(column.wordCount);
+            file.clear();
+            file.seekg(static_cast<std::streamoff>(column.offset));
+            if (!file.read(reinterpret_cast<char*>(column.words.data()),
+                           column.wordCount * sizeof(uint64_t))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    // Открытие архива, возвращает false при ошибке формата
+    bool open(const std::string& filename) {
+        file.close();
+        file.clear();
+        names.clear();
+        seasons.clear();
+        file.open(filename, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+
+        // Размер файла ограничивает все количества из заголовка: поврежденный заголовок
+        // не должен приводить к выделению гигабайтов памяти
+        file.seekg(0, std::ios::end);
+        const uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+        file.seekg(0, std::ios::beg);
+
+        char magic[4];
+        uint32_t version;
+        if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, ARCHIVE_MAGIC, sizeof(magic)) != 0 ||
+            !readValue(file, version) || version != ARCHIVE_VERSION) {
+            return false;
+        }
+
+        uint32_t nameCount;
+        if (!readValue(file, nameCount)) return false;
+        if (static_cast<uint64_t>(nameCount) * sizeof(uint16_t) > fileSize) return false;
+        names.resize(nameCount);
+        for (auto& name : names) {
+            if (!readString(file, name)) return false;
+        }
+
+        uint32_t seasonCount;
+        if (!readValue(file, seasonCount)) return false;
+        if (static_cast<uint64_t>(seasonCount) * SEASON_HEADER_MIN_SIZE > fileSize) return false;
+        seasons.resize(seasonCount);
+        for (auto& season : seasons) {
+            if (!readString(file, season.label) || !readValue(file, season.rows)) return false;
+            // Каждая команда встречается в сезоне один раз
+            if (season.rows > nameCount) return false;
+            for (auto& column : season.columns) {
+                if (!readValue(file, column.offset) || !readValue(file, column.base) ||
+                    !readValue(file, column.bits) || !readValue(file, column.wordCount) ||
+                    column.bits > 32) {
+                    return false;
+                }
+                // Данных должно хватать на все строки сезона, иначе распаковка выйдет за границы
+                if (column.wordCount < (static_cast<uint64_t>(season.rows) * column.bits + 63) / 64) {
+                    return false;
+                }
+                if (column.offset > fileSize ||
+                    static_cast<uint64_t>(column.wordCount) * sizeof(uint64_t) > fileSize - column.offset) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    const std::vector<std::string>& getNames() const { return names; }
+    size_t getSeasonCount() const { return seasons.size(); }
+    const std::string& getSeasonLabel(size_t season) const { return seasons[season].label; }
+
+    // Итоги каждого сезона (номера команд не нужны, столбец TEAM не читается)
+    bool summarizeSeasons(std::vector<SeasonSummary>& result) {
+        result.assign(seasons.size(), SeasonSummary());
+        uint32_t wins[ARCHIVE_BLOCK_SIZE], draws[ARCHIVE_BLOCK_SIZE];
+        uint32_t losses[ARCHIVE_BLOCK_SIZE], points[ARCHIVE_BLOCK_SIZE];
+
+        for (size_t s = 0; s < seasons.size(); ++s) {
+            ArchiveSeason& season = seasons[s];
+            if (!loadColumns(season, NEED_WINS | NEED_DRAWS | NEED_LOSSES)) return false;
+
+            SeasonSummary& summary = result[s];
+            summary.teams = season.rows;
+            unsigned long long totalGames = 0;
+            for (size_t first = 0; first < season.rows; first += ARCHIVE_BLOCK_SIZE) {
+                size_t count = std::min<size_t>(ARCHIVE_BLOCK_SIZE, season.rows - first);
+                unpackColumn(season.columns[COLUMN_WINS], first, count, wins);
+                unpackColumn(season.columns[COLUMN_DRAWS], first, count, draws);
+                unpackColumn(season.columns[COLUMN_LOSSES], first, count, losses);
+                pointsKernel(wins, draws, points, count);
+
+                unsigned long long blockWins = sumKernel(wins, count);
+                unsigned long long blockDraws = sumKernel(draws, count);
+                summary.wins += blockWins;
+                summary.draws += blockDraws;
+                summary.points += sumKernel(points, count);
+                totalGames += blockWins + blockDraws + sumKernel(losses, count);
+            }
+            // Каждый матч учтен у обеих команд
+            summary.games = totalGames / 2;
+            loadColumns(season, 0);
+        }
+        return true;
+    }
+
+    // Итоги каждого клуба по всем сезонам, индекс результата - номер названия в словаре
+    bool summarizeClubs(std::vector<ClubSummary>& result) {
+        result.assign(names.size(), ClubSummary());
+        uint32_t ids[ARCHIVE_BLOCK_SIZE], wins[ARCHIVE_BLOCK_SIZE];
+        uint32_t draws[ARCHIVE_BLOCK_SIZE], losses[ARCHIVE_BLOCK_SIZE], points[ARCHIVE_BLOCK_SIZE];
+
+        for (size_t s = 0; s < seasons.size(); ++s) {
+            ArchiveSeason& season = seasons[s];
+            if (!loadColumns(season, NEED_TEAM | NEED_WINS | NEED_DRAWS | NEED_LOSSES)) return false;
+
+            uint32_t carry = 0;
+            for (size_t first = 0; first < season.rows; first += ARCHIVE_BLOCK_SIZE) {
+                size_t count = std::min<size_t>(ARCHIVE_BLOCK_SIZE, season.rows - first);
+                unpackColumn(season.columns[COLUMN_TEAM], first, count, ids);
+                prefixSumKernel(ids, count, carry);
+                unpackColumn(season.columns[COLUMN_WINS], first, count, wins);
+                unpackColumn(season.columns[COLUMN_DRAWS], first, count, draws);
+                unpackColumn(season.columns[COLUMN_LOSSES], first, count, losses);
+                pointsKernel(wins, draws, points, count);
+
+                for (size_t i = 0; i < count; ++i) {
+                    if (ids[i] >= result.size()) return false;
+                    ClubSummary& club = result[ids[i]];
+                    club.seasons++;
+                    club.wins += wins[i];
+                    club.draws += draws[i];
+                    club.losses += losses[i];
+                    club.games += wins[i] + draws[i] + losses[i];
+                    club.points += points[i];
+                    if (club.bestSeason < 0 || points[i] > club.bestPoints) {
+                        club.bestSeason = static_cast<int>(s);
+                        club.bestPoints = points[i];
+                    }
+                    if (club.worstSeason < 0 || points[i] < club.worstPoints) {
+                        club.worstSeason = static_cast<int>(s);
+                        club.worstPoints = points[i];
+                    }
+                }
+            }
+            loadColumns(season, 0);
+        }
+        return true;
+    }
+};
@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <utility>
+
+// Ожидание в блокирующих операциях очереди: сначала несколько уступок процессора,
+// затем сон с растущим интервалом, чтобы простаивающий поток не занимал ядро
+class QueueBackoff {
+private:
+    static const int YIELD_LIMIT = 16;
+    static const int MAX_SLEEP_US = 10000; // Предел задержки реакции на новый элемент
+
+    int attempts;
+    int sleepUs;
+
+public:
+    QueueBackoff() : attempts(0), sleepUs(50) {}
+
+    void wait() {
+        if (attempts < YIELD_LIMIT) {
+            attempts++;
+            std::this_thread::yield();
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(sleepUs));
+        sleepUs = sleepUs * 2 < MAX_SLEEP_US ? sleepUs * 2 : MAX_SLEEP_US;
+    }
+};
+
+// Ограниченная очередь без блокировок для одного производителя и одного потребителя.
+// Производитель пишет только tail, потребитель - только head, поэтому достаточно
+// атомарных индексов с упорядочиванием acquire/release. Индексы разнесены по разным
+// строкам кэша, чтобы потоки не мешали друг другу.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Емкость очереди должна быть степенью двойки");
+
+private:
+    alignas(64) std::atomic<size_t> head; // Следующий элемент для чтения (пишет потребитель)
+    alignas(64) std::atomic<size_t> tail; // Следующая свободная ячейка (пишет производитель)
+    alignas(64) T buffer[Capacity];
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Добавление элемента, возвращает false, если очередь заполнена
+    bool tryPush(T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        buffer[t & (Capacity - 1)] = std::move(value);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Добавление элемента с ожиданием свободного места (обратное давление на производителя)
+    void push(T value) {
+        QueueBackoff backoff;
+        while (!tryPush(value)) {
+            backoff.wait();
+        }
+    }
+
+    // Извлечение элемента, возвращает false, если очередь пуста
+    bool tryPop(T& value) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (tail.load(std::memory_order_acquire) == h) {
+            return false;
+        }
+        value = std::move(buffer[h & (Capacity - 1)]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Извлечение элемента с ожиданием его появления
+    void pop(T& value) {
+        QueueBackoff backoff;
+        while (!tryPop(value)) {
+            backoff.wait();
+        }
+    }
+};
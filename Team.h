@@ -22,33 +22,38 @@ private:
     unsigned int wins;       // Количество побед
     unsigned int draws;      // Количество ничьих
     unsigned int losses;     // Количество поражений
+    bool dirty;              // Изменена ли команда с момента последнего сохранения
 
 public:
     // Конструктор по умолчанию
-    Team() : name(""), position(0), games(0), wins(0), draws(0), losses(0) {}
+    Team() : name(""), position(0), games(0), wins(0), draws(0), losses(0), dirty(false) {}
 
-    // Конструктор с параметрами
-    Team(const std::string& n) : name(n), position(0), games(0), wins(0), draws(0), losses(0) {}
+    // Конструктор с параметрами (новая команда еще не записана в файл)
+    Team(const std::string& n) : name(n), position(0), games(0), wins(0), draws(0), losses(0), dirty(true) {}
 
     // Геттеры
-    std::string getName() const { return name; }
+    const std::string& getName() const { return name; }
     unsigned int getPosition() const { return position; }
     unsigned int getGames() const { return games; }
     unsigned int getWins() const { return wins; }
     unsigned int getDraws() const { return draws; }
     unsigned int getLosses() const { return losses; }
+    bool isDirty() const { return dirty; }
     
     // Вычисляемое поле - очки (победа = 3 очка, ничья = 1 очко)
     unsigned int getPoints() const { return wins * 3 + draws; }
 
     // Сеттеры
-    void setName(const std::string& n) { name = n; }
+    void setName(const std::string& n) { name = n; dirty = true; }
     void setPosition(unsigned int pos) { position = pos; }
     
     // Методы для обновления статистики
-    void addWin() { wins++; games++; }
-    void addDraw() { draws++; games++; }
-    void addLoss() { losses++; games++; }
+    void addWin() { wins++; games++; dirty = true; }
+    void addDraw() { draws++; games++; dirty = true; }
+    void addLoss() { losses++; games++; dirty = true; }
+
+    // Сброс флага изменений после записи команды в файл
+    void markClean() { dirty = false; }
 
     // Метод для вывода информации о команде
     void display() const {
@@ -7,11 +7,107 @@
 #include <cctype>
 #include <iomanip>
 #include <limits>
+#include <cstdio>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <string_view>
+#include <charconv>
+#include <memory_resource>
+#include <filesystem>
+#include <conio.h>
 #include "Team.h"
+#include "SeasonArchive.h"
+#include "SpscQueue.h"
+
+#ifdef ALLOCATION_COUNT_TEST
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <cstdint>
+
+// Режим проверки выделений памяти: все вызовы operator new подсчитываются
+std::atomic<size_t> allocationCount(0);
+
+// Замененные функции освобождения не встраиваются: иначе GCC видит free() в паре
+// со стандартным operator new и выдает ложное предупреждение -Wmismatched-new-delete
+#if defined(__GNUC__)
+#define ALLOCATION_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define ALLOCATION_NOINLINE __declspec(noinline)
+#else
+#define ALLOCATION_NOINLINE
+#endif
+
+void* operator new(size_t size) {
+    allocationCount++;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+ALLOCATION_NOINLINE void operator delete(void* ptr) noexcept { std::free(ptr); }
+ALLOCATION_NOINLINE void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+ALLOCATION_NOINLINE void operator delete[](void* ptr) noexcept { std::free(ptr); }
+ALLOCATION_NOINLINE void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+// Выровненные версии: через них выделяют память области std::pmr, когда заканчивается буфер.
+// Исходный указатель malloc хранится перед выровненным блоком
+void* operator new(size_t size, std::align_val_t align) {
+    allocationCount++;
+    size_t alignment = static_cast<size_t>(align);
+    void* raw = std::malloc(size + alignment + sizeof(void*));
+    if (!raw) {
+        throw std::bad_alloc();
+    }
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + alignment - 1) &
+                        ~static_cast<uintptr_t>(alignment - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void* operator new[](size_t size, std::align_val_t align) {
+    return operator new(size, align);
+}
+
+ALLOCATION_NOINLINE void operator delete(void* ptr, std::align_val_t) noexcept {
+    if (ptr) std::free(static_cast<void**>(ptr)[-1]);
+}
+ALLOCATION_NOINLINE void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    if (ptr) std::free(static_cast<void**>(ptr)[-1]);
+}
+ALLOCATION_NOINLINE void operator delete[](void* ptr, std::align_val_t) noexcept {
+    if (ptr) std::free(static_cast<void**>(ptr)[-1]);
+}
+ALLOCATION_NOINLINE void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+    if (ptr) std::free(static_cast<void**>(ptr)[-1]);
+}
+#endif
 
 // Глобальный вектор для хранения команд
 std::vector<Team> teams;
 
+// Названия команд, удаленных с момента последнего сохранения
+std::vector<std::string> deletedTeams;
+
+// Количество записей в файле изменений, еще не слитых с основным файлом
+size_t deltaRecordCount = 0;
+
+// Требуется ли полная перезапись основного файла при следующем сохранении
+bool fullSaveRequired = false;
+
+// Строки основного файла на момент последней загрузки или записи (для поиска измененных строк)
+std::vector<std::string> baseFileLines;
+
+// Минимальное количество записей в файле изменений, после которого выполняется слияние
+const size_t MIN_COMPACTION_RECORDS = 32;
+
 // Функция для проверки, содержит ли строка только английские буквы и пробелы
 bool isEnglishString(const std::string& str) {
     if (str.empty()) return false;
@@ -42,24 +138,6 @@ void sortTeams() {
     }
 }
 
-// Функция для сохранения данных в файл
-void saveToFile(const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file) {
-        std::cout << "Ошибка при открытии файла для сохранения!\n";
-        return;
-    }
-
-    for (const auto& team : teams) {
-        file << team.getName() << ","
-             << team.getGames() << ","
-             << team.getWins() << ","
-             << team.getDraws() << ","
-             << team.getLosses() << "\n";
-    }
-    std::cout << "Данные успешно сохранены в файл.\n";
-}
-
 // Функция для проверки корректности данных команды
 bool validateTeamData(const Team& team) {
     // Проверка на отрицательные значения
@@ -92,82 +170,168 @@ bool validateTeamData(const Team& team) {
     return true;
 }
 
-// Функция для загрузки данных из файла
-bool loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file) {
-        std::cout << "Ошибка при открытии файла для чтения!\n";
+// Функция для получения имени файла изменений для основного файла
+std::string getDeltaFilename(const std::string& filename) {
+    return filename + ".delta";
+}
+
+// Функция для разбора числового поля (как std::stoi: пробелы в начале и символы после числа пропускаются)
+std::errc parseNumber(std::string_view text, int& value) {
+    size_t i = 0;
+    while (i < text.size() && std::isspace(static_cast<unsigned char>(text[i]))) i++;
+    if (i + 1 < text.size() && text[i] == '+' && std::isdigit(static_cast<unsigned char>(text[i + 1]))) i++;
+    return std::from_chars(text.data() + i, text.data() + text.size(), value).ec;
+}
+
+// Функция для разбора строки формата "название,игры,победы,ничьи,поражения"
+// Выводит сообщение об ошибке и возвращает false, если строка некорректна.
+// Поля разбираются на месте, без промежуточных строк
+bool parseTeamLine(std::string_view line, int lineNumber, Team& result) {
+    std::string_view fields[5];
+    size_t fieldCount = 0;
+    size_t start = 0;
+    
+    // Разбиваем строку по запятым
+    while (true) {
+        size_t pos = line.find(',', start);
+        if (fieldCount < 5) {
+            fields[fieldCount] = line.substr(start, pos == std::string_view::npos ? pos : pos - start);
+        }
+        fieldCount++;
+        if (pos == std::string_view::npos) break;
+        start = pos + 1;
+    }
+
+    // Проверка количества полей
+    if (fieldCount != 5) {
+        std::cout << "Ошибка в строке " << lineNumber << ": неверное количество полей\n";
         return false;
     }
 
-    std::vector<Team> tempTeams; // Временный вектор для загрузки
+    int counters[3];
+    for (int i = 0; i < 3; ++i) {
+        std::errc error = parseNumber(fields[i + 2], counters[i]);
+        if (error == std::errc::result_out_of_range) {
+            std::cout << "Ошибка в строке " << lineNumber << ": числовые данные слишком большие\n";
+            return false;
+        }
+        if (error != std::errc()) {
+            std::cout << "Ошибка в строке " << lineNumber << ": некорректные числовые данные\n";
+            return false;
+        }
+    }
+
+    Team team{std::string(fields[0])};
+
+    // Добавляем статистику
+    for (int i = 0; i < counters[0]; ++i) team.addWin();
+    for (int i = 0; i < counters[1]; ++i) team.addDraw();
+    for (int i = 0; i < counters[2]; ++i) team.addLoss();
+
+    // Проверяем корректность данных
+    if (!validateTeamData(team)) {
+        std::cout << "Ошибка в строке " << lineNumber << "\n";
+        return false;
+    }
+
+    result = std::move(team);
+    return true;
+}
+
+// Функция для применения файла изменений к загруженным командам
+// Формат записей: "+название,игры,победы,ничьи,поражения" - добавление или обновление команды,
+// "-название" - удаление команды. Возвращает количество прочитанных записей
+size_t applyDeltaFile(const std::string& filename, std::vector<Team>& tempTeams, bool& hasErrors) {
+    std::ifstream file(getDeltaFilename(filename));
+    if (!file) {
+        return 0; // Файла изменений нет - все данные в основном файле
+    }
+
     std::string line;
     int lineNumber = 0;
-    bool hasErrors = false;
+    size_t records = 0;
 
     while (std::getline(file, line)) {
         lineNumber++;
-        size_t pos = 0;
-        std::string token;
-        std::vector<std::string> tokens;
-        
-        // Разбиваем строку по запятым
-        while ((pos = line.find(",")) != std::string::npos) {
-            token = line.substr(0, pos);
-            tokens.push_back(token);
-            line.erase(0, pos + 1);
-        }
-        tokens.push_back(line);
-
-        // Проверка количества полей
-        if (tokens.size() != 5) {
-            std::cout << "Ошибка в строке " << lineNumber << ": неверное количество полей\n";
-            hasErrors = true;
+        if (line.empty()) {
             continue;
         }
+        records++;
 
-        try {
-            Team team(tokens[0]);
-            int wins = std::stoi(tokens[2]);
-            int draws = std::stoi(tokens[3]);
-            int losses = std::stoi(tokens[4]);
-
-            // Добавляем статистику
-            for (int i = 0; i < wins; ++i) team.addWin();
-            for (int i = 0; i < draws; ++i) team.addDraw();
-            for (int i = 0; i < losses; ++i) team.addLoss();
+        char op = line[0];
+        std::string_view record = std::string_view(line).substr(1);
 
-            // Проверяем корректность данных
-            if (!validateTeamData(team)) {
-                std::cout << "Ошибка в строке " << lineNumber << "\n";
+        if (op == '-') {
+            auto it = std::find_if(tempTeams.begin(), tempTeams.end(),
+                [&](const Team& t) { return t.getName() == record; });
+            if (it != tempTeams.end()) {
+                tempTeams.erase(it);
+            }
+        }
+        else if (op == '+') {
+            Team team;
+            if (!parseTeamLine(record, lineNumber, team)) {
+                std::cout << "Ошибка в файле изменений\n";
                 hasErrors = true;
                 continue;
             }
 
-            // Проверяем уникальность названия команды
             auto it = std::find_if(tempTeams.begin(), tempTeams.end(),
                 [&](const Team& t) { return t.getName() == team.getName(); });
             if (it != tempTeams.end()) {
-                std::cout << "Ошибка в строке " << lineNumber << ": команда \"" 
-                         << team.getName() << "\" уже существует\n";
-                hasErrors = true;
-                continue;
+                *it = std::move(team);
+            } else {
+                tempTeams.push_back(std::move(team));
             }
-
-            tempTeams.push_back(team);
         }
-        catch (const std::invalid_argument& e) {
-            std::cout << "Ошибка в строке " << lineNumber << ": некорректные числовые данные\n";
+        else {
+            std::cout << "Ошибка в строке " << lineNumber << " файла изменений: неизвестная операция\n";
+            hasErrors = true;
+        }
+    }
+
+    return records;
+}
+
+// Функция для загрузки данных из файла
+bool loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        std::cout << "Ошибка при открытии файла для чтения!\n";
+        return false;
+    }
+
+    std::vector<Team> tempTeams; // Временный вектор для загрузки
+    std::vector<std::string> tempLines;
+    std::string line;
+    int lineNumber = 0;
+    bool hasErrors = false;
+
+    while (std::getline(file, line)) {
+        lineNumber++;
+        tempLines.push_back(line);
+        Team team;
+        if (!parseTeamLine(line, lineNumber, team)) {
             hasErrors = true;
             continue;
         }
-        catch (const std::out_of_range& e) {
-            std::cout << "Ошибка в строке " << lineNumber << ": числовые данные слишком большие\n";
+
+        // Проверяем уникальность названия команды
+        auto it = std::find_if(tempTeams.begin(), tempTeams.end(),
+            [&](const Team& t) { return t.getName() == team.getName(); });
+        if (it != tempTeams.end()) {
+            std::cout << "Ошибка в строке " << lineNumber << ": команда \"" 
+                     << team.getName() << "\" уже существует\n";
             hasErrors = true;
             continue;
         }
+
+        tempTeams.push_back(std::move(team));
     }
 
+    // Применяем изменения, сохраненные после последнего слияния
+    size_t deltaRecords = applyDeltaFile(filename, tempTeams, hasErrors);
+
     if (hasErrors) {
         std::cout << "\nФайл содержит ошибки. Загрузить данные? (y/n): ";
         char choice;
@@ -181,12 +345,321 @@ bool loadFromFile(const std::string& filename) {
     }
 
     // Если все проверки пройдены или пользователь согласился загрузить данные с ошибками
-    teams = tempTeams;
+    teams = std::move(tempTeams);
+    baseFileLines = std::move(tempLines);
+    for (auto& team : teams) {
+        team.markClean();
+    }
+    deletedTeams.clear();
+    deltaRecordCount = deltaRecords;
+    // Ошибочные строки остались в файле - при следующем сохранении файл перезаписывается целиком
+    fullSaveRequired = hasErrors;
     sortTeams();
     std::cout << "Данные успешно загружены из файла.\n";
     return true;
 }
 
+// Функция для формирования строки команды в формате файла базы данных
+std::string formatTeamLine(const Team& team) {
+    return team.getName() + "," +
+           std::to_string(team.getGames()) + "," +
+           std::to_string(team.getWins()) + "," +
+           std::to_string(team.getDraws()) + "," +
+           std::to_string(team.getLosses());
+}
+
+// Функция для полной перезаписи основного файла (слияние файла изменений)
+bool compactDatabase(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file) {
+        return false;
+    }
+
+    std::vector<std::string> lines;
+    for (const auto& team : teams) {
+        lines.push_back(formatTeamLine(team));
+        file << lines.back() << "\n";
+    }
+    file.close();
+    if (!file) {
+        return false;
+    }
+    baseFileLines = std::move(lines);
+
+    // Все изменения вошли в основной файл - файл изменений больше не нужен
+    std::remove(getDeltaFilename(filename).c_str());
+    deltaRecordCount = 0;
+    fullSaveRequired = false;
+    return true;
+}
+
+// Функция для сохранения данных в файл
+// Записывает только команды, измененные с последнего сохранения, в файл изменений.
+// Когда файл изменений становится сравним по размеру с таблицей, он сливается с основным файлом
+void saveToFile(const std::string& filename) {
+    size_t changed = deletedTeams.size() + std::count_if(teams.begin(), teams.end(),
+        [](const Team& t) { return t.isDirty(); });
+
+    if (changed == 0 && !fullSaveRequired) {
+        std::cout << "Изменений нет, данные уже сохранены.\n";
+        return;
+    }
+
+    bool compact = fullSaveRequired ||
+        deltaRecordCount + changed > std::max(MIN_COMPACTION_RECORDS, teams.size() / 2);
+
+    if (compact) {
+        if (!compactDatabase(filename)) {
+            std::cout << "Ошибка при открытии файла для сохранения!\n";
+            return;
+        }
+    } else {
+        std::ofstream file(getDeltaFilename(filename), std::ios::app);
+        if (!file) {
+            std::cout << "Ошибка при открытии файла для сохранения!\n";
+            return;
+        }
+
+        // Удаления записываются первыми, чтобы повторно созданная команда не была потеряна
+        for (const auto& name : deletedTeams) {
+            file << "-" << name << "\n";
+        }
+        for (const auto& team : teams) {
+            if (team.isDirty()) {
+                file << "+" << formatTeamLine(team) << "\n";
+            }
+        }
+        file.close();
+        if (!file) {
+            std::cout << "Ошибка при записи файла изменений!\n";
+            return;
+        }
+        deltaRecordCount += changed;
+    }
+
+    for (auto& team : teams) {
+        team.markClean();
+    }
+    deletedTeams.clear();
+    std::cout << "Данные успешно сохранены в файл.\n";
+}
+
+// Функция для пересортировки таблицы после изменения нескольких команд.
+// Остальные команды уже упорядочены по очкам, поэтому сортируются только измененные,
+// а затем они сливаются с остальной таблицей за линейное время
+void rerankChangedTeams(const std::unordered_set<std::string_view>& changedNames) {
+    auto byPoints = [](const Team& a, const Team& b) { return a.getPoints() > b.getPoints(); };
+
+    auto changed = std::stable_partition(teams.begin(), teams.end(), [&](const Team& t) {
+        return changedNames.count(t.getName()) == 0;
+    });
+
+    // Таблица могла быть отсортирована по другому признаку (меню сортировки)
+    if (!std::is_sorted(teams.begin(), changed, byPoints)) {
+        sortTeams();
+        return;
+    }
+
+    std::sort(changed, teams.end(), byPoints);
+    std::inplace_merge(teams.begin(), changed, teams.end(), byPoints);
+
+    for (size_t i = 0; i < teams.size(); ++i) {
+        teams[i].setPosition(i + 1);
+    }
+}
+
+// Функция для получения названия команды из строки файла (до первой запятой)
+std::string_view lineTeamName(std::string_view line) {
+    return line.substr(0, line.find(','));
+}
+
+// Функция для применения внешних изменений основного файла.
+// Строки сравниваются с сохраненной копией файла: общее начало и общий конец пропускаются,
+// разбираются только строки измененного диапазона. Возвращает true, если таблица изменилась
+bool reloadChangedLines(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        std::cout << "Ошибка при открытии файла для чтения!\n";
+        return false;
+    }
+
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(file, line)) {
+        lines.push_back(line);
+    }
+
+    // Границы измененного диапазона: [prefix, oldEnd) в старом файле и [prefix, newEnd) в новом
+    size_t prefix = 0;
+    while (prefix < lines.size() && prefix < baseFileLines.size() && lines[prefix] == baseFileLines[prefix]) {
+        prefix++;
+    }
+    size_t oldEnd = baseFileLines.size();
+    size_t newEnd = lines.size();
+    while (oldEnd > prefix && newEnd > prefix && lines[newEnd - 1] == baseFileLines[oldEnd - 1]) {
+        oldEnd--;
+        newEnd--;
+    }
+
+    if (prefix == oldEnd && prefix == newEnd) {
+        return false;
+    }
+
+    // Строки диапазона, которые только сместились (например, при удалении строки выше),
+    // не разбираются повторно
+    std::vector<std::string_view> oldRange(baseFileLines.begin() + prefix, baseFileLines.begin() + oldEnd);
+    std::vector<std::string_view> newRange(lines.begin() + prefix, lines.begin() + newEnd);
+    std::sort(oldRange.begin(), oldRange.end());
+    std::sort(newRange.begin(), newRange.end());
+
+    auto isChangedLine = [&](size_t i) {
+        return i >= prefix && i < newEnd &&
+               !std::binary_search(oldRange.begin(), oldRange.end(), std::string_view(lines[i]));
+    };
+    auto isRemovedLine = [&](size_t i) {
+        return i >= prefix && i < oldEnd &&
+               !std::binary_search(newRange.begin(), newRange.end(), std::string_view(baseFileLines[i]));
+    };
+
+    // Команды, которых касаются новые, измененные и удаленные строки
+    std::unordered_set<std::string_view> affectedNames;
+    size_t parsedLines = 0;
+    size_t removedLines = 0;
+    for (size_t i = prefix; i < newEnd; ++i) {
+        if (isChangedLine(i)) {
+            parsedLines++;
+            affectedNames.insert(lineTeamName(lines[i]));
+        }
+    }
+    for (size_t i = prefix; i < oldEnd; ++i) {
+        if (isRemovedLine(i)) {
+            removedLines++;
+            affectedNames.insert(lineTeamName(baseFileLines[i]));
+        }
+    }
+
+    // Строки нового файла по названиям команд: первая строка и следующая строка с тем же названием.
+    // Как и при полной загрузке, команду определяет первая корректная строка, остальные - дубликаты
+    const size_t NO_LINE = std::numeric_limits<size_t>::max();
+    std::unordered_map<std::string_view, size_t> firstLine;
+    std::vector<size_t> nextSameName(lines.size(), NO_LINE);
+    {
+        std::unordered_map<std::string_view, size_t> lastLine;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            std::string_view name = lineTeamName(lines[i]);
+            auto last = lastLine.find(name);
+            if (last == lastLine.end()) {
+                firstLine[name] = i;
+                lastLine[name] = i;
+            } else {
+                nextSameName[last->second] = i;
+                last->second = i;
+            }
+        }
+    }
+
+    // Первые строки названий в старом файле (нужны, только если строки удалялись)
+    std::unordered_map<std::string_view, size_t> oldFirstLine;
+    if (removedLines > 0) {
+        for (size_t i = 0; i < baseFileLines.size(); ++i) {
+            oldFirstLine.emplace(lineTeamName(baseFileLines[i]), i);
+        }
+    }
+
+    // Позиции затронутых команд в таблице (один проход по таблице)
+    std::unordered_map<std::string_view, size_t> teamIndex;
+    for (size_t i = 0; i < teams.size(); ++i) {
+        auto affected = affectedNames.find(teams[i].getName());
+        if (affected != affectedNames.end()) {
+            teamIndex[*affected] = i;
+        }
+    }
+
+    std::unordered_set<std::string_view> changedNames;
+    std::unordered_set<std::string_view> removedNames;
+    for (std::string_view name : affectedNames) {
+        auto position = teamIndex.find(name);
+        bool inTable = position != teamIndex.end();
+
+        // Неизмененная строка заново разбирается, если команды нет в таблице
+        // или удалена строка, которая определяла команду раньше
+        bool reparse = !inTable;
+        auto oldFirst = oldFirstLine.find(name);
+        if (oldFirst != oldFirstLine.end() && isRemovedLine(oldFirst->second)) {
+            reparse = true;
+        }
+
+        auto first = firstLine.find(name);
+        size_t defining = NO_LINE;
+        for (size_t i = first == firstLine.end() ? NO_LINE : first->second; i != NO_LINE; i = nextSameName[i]) {
+            if (defining != NO_LINE) {
+                if (isChangedLine(i)) {
+                    std::cout << "Ошибка в строке " << (i + 1) << ": команда \""
+                              << name << "\" уже существует\n";
+                    fullSaveRequired = true; // Дубликат будет убран при следующем сохранении
+                }
+                continue;
+            }
+
+            // Команда в таблице уже соответствует этой строке
+            if (!isChangedLine(i) && !reparse) {
+                defining = i;
+                continue;
+            }
+
+            Team team;
+            if (!parseTeamLine(lines[i], static_cast<int>(i + 1), team)) {
+                fullSaveRequired = true; // Ошибочная строка будет исправлена при следующем сохранении
+                continue;
+            }
+            defining = i;
+
+            // Если есть файл изменений, его записи перекрыли бы новые данные при загрузке,
+            // поэтому команда сохраняется в файл изменений заново
+            if (deltaRecordCount == 0) {
+                team.markClean();
+            }
+
+            changedNames.insert(name);
+
+            // Команда, удаленная локально до внешней правки, снова есть в файле - удаление отменяется
+            deletedTeams.erase(std::remove(deletedTeams.begin(), deletedTeams.end(), team.getName()),
+                               deletedTeams.end());
+
+            if (inTable) {
+                teams[position->second] = std::move(team);
+            } else {
+                teams.push_back(std::move(team));
+            }
+        }
+
+        // Строки с командой есть, но все ошибочные - команда остается без изменений
+        if (first != firstLine.end() || !inTable) {
+            continue;
+        }
+
+        // Ни одной строки с командой не осталось
+        if (deltaRecordCount > 0) {
+            deletedTeams.push_back(std::string(name));
+        }
+        removedNames.insert(name);
+    }
+
+    // Удаление команд одним проходом по таблице
+    if (!removedNames.empty()) {
+        teams.erase(std::remove_if(teams.begin(), teams.end(),
+            [&](const Team& t) { return removedNames.count(t.getName()) > 0; }), teams.end());
+    }
+
+    std::cout << "\nФайл изменен: новых или измененных строк - " << parsedLines
+              << ", удаленных строк - " << removedLines << "\n";
+
+    // Названия указывают на строки старой и новой копий файла, поэтому копия заменяется последней
+    rerankChangedTeams(changedNames);
+    baseFileLines = std::move(lines);
+    return parsedLines > 0 || removedLines > 0;
+}
+
 // Функция для отображения всех команд
 void displayAllTeams() {
     if (teams.empty()) {
@@ -203,20 +676,93 @@ void displayAllTeams() {
     }
 }
 
+// Функция для наблюдения за изменениями основного файла.
+// При каждом изменении файла другими программами в таблицу вносятся только измененные строки
+void watchDatabaseFile(const std::string& filename) {
+    namespace fs = std::filesystem;
+    std::string directory = fs::path(filename).parent_path().string();
+    if (directory.empty()) {
+        directory = ".";
+    }
+
+    HANDLE change = FindFirstChangeNotificationA(directory.c_str(), FALSE,
+        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_FILE_NAME);
+    if (change == INVALID_HANDLE_VALUE) {
+        std::cout << "Ошибка: не удалось начать наблюдение за файлом!\n";
+        return;
+    }
+
+    std::cout << "Наблюдение за файлом \"" << filename << "\". Нажмите любую клавишу для выхода.\n";
+
+    std::error_code error;
+    fs::file_time_type lastWrite = fs::last_write_time(filename, error);
+    while (!_kbhit()) {
+        if (WaitForSingleObject(change, 200) != WAIT_OBJECT_0) {
+            continue;
+        }
+
+        // Уведомление приходит на весь каталог - проверяем, что изменился именно файл базы
+        fs::file_time_type currentWrite = fs::last_write_time(filename, error);
+        if (!error && currentWrite != lastWrite) {
+            Sleep(100); // Даем записывающей программе закончить запись
+            lastWrite = fs::last_write_time(filename, error);
+            if (reloadChangedLines(filename)) {
+                displayAllTeams();
+            }
+        }
+
+        if (!FindNextChangeNotification(change)) {
+            std::cout << "Ошибка: наблюдение за файлом прервано!\n";
+            break;
+        }
+    }
+    if (_kbhit()) {
+        _getch();
+    }
+
+    FindCloseChangeNotification(change);
+    std::cout << "Наблюдение за файлом завершено.\n";
+}
+
+// Функция для поиска подстроки без учета регистра
+bool containsIgnoreCase(std::string_view text, std::string_view pattern) {
+    if (pattern.size() > text.size()) return false;
+    for (size_t i = 0; i + pattern.size() <= text.size(); ++i) {
+        size_t j = 0;
+        while (j < pattern.size() &&
+               std::tolower(static_cast<unsigned char>(text[i + j])) ==
+               std::tolower(static_cast<unsigned char>(pattern[j]))) {
+            j++;
+        }
+        if (j == pattern.size()) return true;
+    }
+    return false;
+}
+
+// Буфер для временных списков операций поиска. Размер следует за размером таблицы,
+// поэтому после первого поиска по таблице данного размера память в куче не выделяется.
+// Буфер общий: одновременно может существовать только одна область поиска
+std::vector<std::max_align_t> searchBuffer;
+
+// Функция для создания области памяти, вмещающей список указателей на все команды таблицы
+std::pmr::monotonic_buffer_resource makeSearchArena() {
+    size_t needed = (teams.size() * sizeof(Team*) + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t) + 1;
+    if (searchBuffer.size() < needed) {
+        searchBuffer.resize(needed * 2); // С запасом, чтобы не расширять буфер при каждой новой команде
+    }
+    return std::pmr::monotonic_buffer_resource(searchBuffer.data(), searchBuffer.size() * sizeof(std::max_align_t));
+}
+
 // Функция для поиска похожих команд
-std::vector<std::string> findSimilarTeams(const std::string& name) {
-    std::vector<std::string> similar;
-    std::string lowerName = name;
-    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+// Возвращает указатели на команды в векторе teams; память под результат берется из arena
+// (область из makeSearchArena вмещает результат целиком)
+std::pmr::vector<const Team*> findSimilarTeams(std::string_view name, std::pmr::memory_resource* arena) {
+    std::pmr::vector<const Team*> similar(arena);
+    similar.reserve(teams.size());
     
     for (const auto& team : teams) {
-        std::string teamName = team.getName();
-        std::string lowerTeamName = teamName;
-        std::transform(lowerTeamName.begin(), lowerTeamName.end(), lowerTeamName.begin(), ::tolower);
-        
-        if (lowerTeamName.find(lowerName) != std::string::npos || 
-            lowerName.find(lowerTeamName) != std::string::npos) {
-            similar.push_back(teamName);
+        if (containsIgnoreCase(team.getName(), name) || containsIgnoreCase(name, team.getName())) {
+            similar.push_back(&team);
         }
     }
     return similar;
@@ -234,14 +780,15 @@ std::string getTeamNameFromUser(const std::string& prompt, const std::string& ex
             continue;
         }
 
-        // Поиск похожих команд
-        auto similarTeams = findSimilarTeams(teamName);
+        // Поиск похожих команд (результат размещается в буфере поиска)
+        auto arena = makeSearchArena();
+        auto similarTeams = findSimilarTeams(teamName, &arena);
         
         // Удаляем исключенную команду из списка похожих
         if (!excludeTeam.empty()) {
             similarTeams.erase(
                 std::remove_if(similarTeams.begin(), similarTeams.end(),
-                    [&](const std::string& team) { return team == excludeTeam; }),
+                    [&](const Team* team) { return team->getName() == excludeTeam; }),
                 similarTeams.end()
             );
         }
@@ -249,7 +796,7 @@ std::string getTeamNameFromUser(const std::string& prompt, const std::string& ex
         if (!similarTeams.empty()) {
             std::cout << "\nНайдены похожие команды:\n";
             for (size_t i = 0; i < similarTeams.size(); ++i) {
-                std::cout << (i + 1) << ". " << similarTeams[i] << "\n";
+                std::cout << (i + 1) << ". " << similarTeams[i]->getName() << "\n";
             }
             std::cout << "0. Создать новую команду\n";
             std::cout << "Выберите номер команды или 0 для создания новой: ";
@@ -282,11 +829,11 @@ std::string getTeamNameFromUser(const std::string& prompt, const std::string& ex
                 continue; // Если отказались создавать новую команду, начинаем сначала
             } else {
                 // Проверяем, не совпадает ли выбранная команда с исключенной
-                if (similarTeams[choice - 1] == excludeTeam) {
+                if (similarTeams[choice - 1]->getName() == excludeTeam) {
                     std::cout << "Ошибка: нельзя выбрать ту же команду!\n";
                     continue;
                 }
-                return similarTeams[choice - 1];
+                return similarTeams[choice - 1]->getName();
             }
         } else {
             // Проверяем, не совпадает ли новая команда с исключенной
@@ -310,6 +857,26 @@ std::string getTeamNameFromUser(const std::string& prompt, const std::string& ex
     }
 }
 
+// Функция для применения результата матча к существующим командам
+// ('V' - победа первой команды, 'D' - ничья)
+void applyMatchResult(char result, std::string_view team1, std::string_view team2) {
+    auto first = std::find_if(teams.begin(), teams.end(),
+        [&](const Team& t) { return t.getName() == team1; });
+    auto second = std::find_if(teams.begin(), teams.end(),
+        [&](const Team& t) { return t.getName() == team2; });
+    if (first == teams.end() || second == teams.end()) {
+        return;
+    }
+
+    if (result == 'V') {
+        first->addWin();
+        second->addLoss();
+    } else {
+        first->addDraw();
+        second->addDraw();
+    }
+}
+
 // Функция для добавления результата матча
 void addMatchResult() {
     int matchCount;
@@ -347,26 +914,14 @@ void addMatchResult() {
             std::string winner = getTeamNameFromUser("Введите название команды-победителя (на английском): ");
             std::string loser = getTeamNameFromUser("Введите название проигравшей команды (на английском): ", winner);
 
-            auto winTeam = std::find_if(teams.begin(), teams.end(),
-                [&](const Team& t) { return t.getName() == winner; });
-            auto loseTeam = std::find_if(teams.begin(), teams.end(),
-                [&](const Team& t) { return t.getName() == loser; });
-
-            winTeam->addWin();
-            loseTeam->addLoss();
+            applyMatchResult('V', winner, loser);
             std::cout << "Результат матча успешно добавлен.\n";
         }
         else { // Ничья
             std::string team1 = getTeamNameFromUser("Введите название первой команды (на английском): ");
             std::string team2 = getTeamNameFromUser("Введите название второй команды (на английском): ", team1);
 
-            auto team1It = std::find_if(teams.begin(), teams.end(),
-                [&](const Team& t) { return t.getName() == team1; });
-            auto team2It = std::find_if(teams.begin(), teams.end(),
-                [&](const Team& t) { return t.getName() == team2; });
-
-            team1It->addDraw();
-            team2It->addDraw();
+            applyMatchResult('D', team1, team2);
             std::cout << "Результат матча успешно добавлен.\n";
         }
     }
@@ -407,14 +962,7 @@ void searchTeam() {
     
     for (const auto& team : teams) {
         // Поиск подстроки в названии команды (нечувствительный к регистру)
-        std::string teamName = team.getName();
-        std::string query = searchQuery;
-        
-        // Преобразование к нижнему регистру для сравнения
-        std::transform(teamName.begin(), teamName.end(), teamName.begin(), ::tolower);
-        std::transform(query.begin(), query.end(), query.begin(), ::tolower);
-        
-        if (teamName.find(query) != std::string::npos) {
+        if (containsIgnoreCase(team.getName(), searchQuery)) {
             team.display();
             found = true;
         }
@@ -477,17 +1025,15 @@ void deleteTeam() {
     
     while (tryAgain) {
         std::string teamName = getTeamNameFromUser("Введите название или часть названия команды для удаления (на английском): ");
-        std::vector<Team*> foundTeams;
         
-        // Преобразуем введенное имя в нижний регистр для сравнения
-        std::string searchName = teamName;
-        std::transform(searchName.begin(), searchName.end(), searchName.begin(), ::tolower);
+        // Список найденных команд размещается в буфере поиска
+        auto arena = makeSearchArena();
+        std::pmr::vector<Team*> foundTeams(&arena);
+        foundTeams.reserve(teams.size());
         
-        // Ищем все команды, содержащие введенную подстроку
+        // Ищем все команды, содержащие введенную подстроку (без учета регистра)
         for (auto& team : teams) {
-            std::string currentName = team.getName();
-            std::transform(currentName.begin(), currentName.end(), currentName.begin(), ::tolower);
-            if (currentName.find(searchName) != std::string::npos) {
+            if (containsIgnoreCase(team.getName(), teamName)) {
                 foundTeams.push_back(&team);
             }
         }
@@ -541,8 +1087,10 @@ void deleteTeam() {
                 auto it = std::find_if(teams.begin(), teams.end(),
                     [&](const Team& t) { return &t == selectedTeam; });
                 if (it != teams.end()) {
+                    std::string deletedName = it->getName();
+                    deletedTeams.push_back(deletedName);
                     teams.erase(it);
-                    std::cout << "Команда \"" << selectedTeam->getName() << "\" успешно удалена.\n";
+                    std::cout << "Команда \"" << deletedName << "\" успешно удалена.\n";
                     std::cout << "Не забудьте сохранить изменения через меню.\n";
                     sortTeams();
                 }
@@ -565,8 +1113,10 @@ void deleteTeam() {
                 auto it = std::find_if(teams.begin(), teams.end(),
                     [&](const Team& t) { return &t == selectedTeam; });
                 if (it != teams.end()) {
+                    std::string deletedName = it->getName();
+                    deletedTeams.push_back(deletedName);
                     teams.erase(it);
-                    std::cout << "Команда \"" << selectedTeam->getName() << "\" успешно удалена.\n";
+                    std::cout << "Команда \"" << deletedName << "\" успешно удалена.\n";
                     std::cout << "Не забудьте сохранить изменения через меню.\n";
                     sortTeams();
                 }
@@ -579,6 +1129,438 @@ void deleteTeam() {
     }
 }
 
+// Имя файла архива сезонов
+const std::string SEASON_ARCHIVE_FILE = "seasons_archive.dat";
+
+// Функция для чтения таблицы сезона из файла в формате football_database.txt
+bool loadSeasonFile(const std::string& filename, std::vector<Team>& season) {
+    std::ifstream file(filename);
+    if (!file) {
+        std::cout << "Ошибка при открытии файла \"" << filename << "\"!\n";
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    bool hasErrors = false;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        Team team;
+        if (!parseTeamLine(line, lineNumber, team)) {
+            hasErrors = true;
+            continue;
+        }
+
+        // Проверяем уникальность названия команды
+        auto it = std::find_if(season.begin(), season.end(),
+            [&](const Team& t) { return t.getName() == team.getName(); });
+        if (it != season.end()) {
+            std::cout << "Ошибка в строке " << lineNumber << ": команда \"" 
+                     << team.getName() << "\" уже существует\n";
+            hasErrors = true;
+            continue;
+        }
+
+        season.push_back(std::move(team));
+    }
+    return !hasErrors;
+}
+
+// Функция для создания архива сезонов из файлов таблиц
+void buildSeasonArchive() {
+    int seasonCount;
+    std::cout << "Сколько сезонов добавить в архив: ";
+    while (!(std::cin >> seasonCount) || seasonCount <= 0) {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Ошибка! Введите положительное число: ";
+    }
+    std::cin.ignore();
+
+    std::vector<std::string> labels;
+    std::vector<std::vector<Team>> seasons;
+    for (int i = 0; i < seasonCount; ++i) {
+        std::cout << "\nСезон " << (i + 1) << " из " << seasonCount << "\n";
+        std::string label, filename;
+        std::cout << "Введите название сезона (например, 2023/24): ";
+        std::getline(std::cin, label);
+        std::cout << "Введите имя файла таблицы сезона: ";
+        std::getline(std::cin, filename);
+
+        std::vector<Team> season;
+        if (!loadSeasonFile(filename, season)) {
+            std::cout << "Файл сезона содержит ошибки. Создание архива отменено.\n";
+            return;
+        }
+        labels.push_back(label);
+        seasons.push_back(season);
+    }
+
+    if (!writeSeasonArchive(SEASON_ARCHIVE_FILE, labels, seasons)) {
+        std::cout << "Ошибка при записи архива сезонов!\n";
+        return;
+    }
+    std::cout << "Архив сезонов успешно создан: " << SEASON_ARCHIVE_FILE << "\n";
+}
+
+// Функция для вывода итогов по сезонам
+void displaySeasonReport(SeasonArchive& archive) {
+    std::vector<SeasonSummary> summaries;
+    if (!archive.summarizeSeasons(summaries)) {
+        std::cout << "Ошибка при чтении архива сезонов!\n";
+        return;
+    }
+
+    std::cout << "\nСезон         Команд Матчей  Побед Ничьих Ср.очки\n";
+    std::cout << std::string(50, '-') << std::endl;
+    for (size_t s = 0; s < summaries.size(); ++s) {
+        const SeasonSummary& summary = summaries[s];
+        double averagePoints = summary.teams ? static_cast<double>(summary.points) / summary.teams : 0.0;
+        std::cout << std::left << std::setw(14) << archive.getSeasonLabel(s)
+                  << std::right
+                  << std::setw(6) << summary.teams << " "
+                  << std::setw(6) << summary.games << " "
+                  << std::setw(6) << summary.wins << " "
+                  << std::setw(6) << summary.draws << " "
+                  << std::setw(7) << std::fixed << std::setprecision(1) << averagePoints
+                  << std::endl;
+    }
+}
+
+// Функция для вывода итогов по клубам (суммы, средние, лучший и худший сезоны)
+void displayClubReport(SeasonArchive& archive) {
+    std::vector<ClubSummary> clubs;
+    if (!archive.summarizeClubs(clubs)) {
+        std::cout << "Ошибка при чтении архива сезонов!\n";
+        return;
+    }
+
+    // Клубы упорядочиваются по сумме очков за все сезоны
+    std::vector<size_t> order;
+    for (size_t i = 0; i < clubs.size(); ++i) {
+        if (clubs[i].seasons > 0) order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return clubs[a].points > clubs[b].points;
+    });
+
+    std::cout << "\nНазвание             Сез  Игры  Поб  Нич  Пор  Очки Ср.очки  Лучший     Худший\n";
+    std::cout << std::string(86, '-') << std::endl;
+    for (size_t i : order) {
+        const ClubSummary& club = clubs[i];
+        const std::string& name = archive.getNames()[i];
+        int nameLength = utf8_strlen(name);
+        std::cout << std::left << name << std::string(nameLength < 20 ? 20 - nameLength : 1, ' ')
+                  << std::right
+                  << std::setw(4) << club.seasons << " "
+                  << std::setw(5) << club.games << " "
+                  << std::setw(4) << club.wins << " "
+                  << std::setw(4) << club.draws << " "
+                  << std::setw(4) << club.losses << " "
+                  << std::setw(5) << club.points << " "
+                  << std::setw(7) << std::fixed << std::setprecision(1)
+                  << static_cast<double>(club.points) / club.seasons << "  "
+                  << std::left
+                  << std::setw(10) << archive.getSeasonLabel(club.bestSeason) << " "
+                  << archive.getSeasonLabel(club.worstSeason)
+                  << std::right << std::endl;
+    }
+}
+
+// Функция для работы с архивом сезонов
+void seasonArchiveMenu() {
+    std::cout << "\nАрхив сезонов:\n";
+    std::cout << "1. Создать архив из файлов сезонов\n";
+    std::cout << "2. Итоги по сезонам\n";
+    std::cout << "3. Итоги по клубам\n";
+    std::cout << "Выберите действие: ";
+
+    int choice;
+    std::cin >> choice;
+    std::cin.ignore();
+
+    if (choice == 1) {
+        buildSeasonArchive();
+        return;
+    }
+    if (choice != 2 && choice != 3) {
+        std::cout << "Неверный выбор.\n";
+        return;
+    }
+
+    SeasonArchive archive;
+    if (!archive.open(SEASON_ARCHIVE_FILE)) {
+        std::cout << "Не удалось открыть архив сезонов \"" << SEASON_ARCHIVE_FILE << "\"!\n";
+        return;
+    }
+    if (choice == 2) {
+        displaySeasonReport(archive);
+    } else {
+        displayClubReport(archive);
+    }
+}
+
+// Результат матча, поступивший в режиме матчдня
+struct MatchEvent {
+    char result = 0;              // 'V' - победа первой команды, 'D' - ничья, 0 - конец потока
+    std::string team1;            // Победитель или первая команда
+    std::string team2;            // Проигравший или вторая команда
+    std::chrono::steady_clock::time_point arrival; // Момент получения строки
+};
+
+// Обновленная таблица для вывода
+struct StandingsUpdate {
+    bool last = false;            // Последнее обновление - поток результатов закончился
+    size_t matches = 0;           // Количество матчей, вошедших в обновление
+    std::chrono::steady_clock::time_point oldestArrival; // Самый ранний результат пакета
+    std::vector<Team> table;      // Снимок таблицы после пересортировки
+};
+
+// Максимальное количество результатов, объединяемых в одну пересортировку
+const size_t MATCHDAY_BATCH_SIZE = 64;
+
+// Функция для разбора строки результата "V,победитель,проигравший" или "D,команда1,команда2"
+bool parseMatchLine(const std::string& line, MatchEvent& event) {
+    size_t first = line.find(',');
+    size_t second = first == std::string::npos ? std::string::npos : line.find(',', first + 1);
+    if (first != 1 || second == std::string::npos) {
+        return false;
+    }
+
+    event.result = static_cast<char>(std::toupper(static_cast<unsigned char>(line[0])));
+    event.team1 = line.substr(first + 1, second - first - 1);
+    event.team2 = line.substr(second + 1);
+    if (!event.team2.empty() && event.team2.back() == '\r') {
+        event.team2.pop_back();
+    }
+
+    return (event.result == 'V' || event.result == 'D') &&
+           isEnglishString(event.team1) && isEnglishString(event.team2) &&
+           event.team1 != event.team2;
+}
+
+// Функция для поиска команды по названию с созданием новой при отсутствии.
+// Возвращает индекс в teams: создание команды может перераспределить вектор
+size_t findOrCreateTeam(std::unordered_map<std::string, size_t>& index, const std::string& name) {
+    auto it = index.find(name);
+    if (it != index.end()) {
+        return it->second;
+    }
+    teams.emplace_back(name);
+    index[name] = teams.size() - 1;
+    return teams.size() - 1;
+}
+
+// Функция для приема результатов матчей в режиме реального времени.
+// Три стадии соединены очередями без блокировок: чтение строк из файла или канала,
+// применение результатов с пересортировкой пакетами и вывод таблицы
+void runMatchdayPipeline() {
+    std::cout << "Введите имя файла или канала с результатами матчей: ";
+    std::string filename;
+    std::getline(std::cin, filename);
+
+    std::ifstream input(filename);
+    if (!input) {
+        std::cout << "Ошибка при открытии файла \"" << filename << "\"!\n";
+        return;
+    }
+
+    SpscQueue<MatchEvent, 1024> events;
+    SpscQueue<StandingsUpdate, 4> updates;
+    size_t invalidLines = 0;
+
+    // Стадия чтения: разбор строк по мере поступления
+    std::thread ingest([&]() {
+        std::string line;
+        while (std::getline(input, line)) {
+            MatchEvent event;
+            event.arrival = std::chrono::steady_clock::now();
+            if (line.empty() || (line.size() == 1 && line[0] == '\r')) {
+                continue;
+            }
+            if (!parseMatchLine(line, event)) {
+                invalidLines++;
+                continue;
+            }
+            events.push(std::move(event));
+        }
+        events.push(MatchEvent()); // Признак конца потока
+    });
+
+    // Стадия ранжирования: все накопившиеся результаты применяются за одну пересортировку
+    std::thread ranking([&]() {
+        std::unordered_map<std::string, size_t> index;
+        for (size_t i = 0; i < teams.size(); ++i) {
+            index[teams[i].getName()] = i;
+        }
+
+        bool finished = false;
+        MatchEvent event;
+        while (!finished) {
+            events.pop(event);
+            StandingsUpdate update;
+            update.oldestArrival = event.arrival;
+
+            while (true) {
+                if (event.result == 0) {
+                    finished = true;
+                    break;
+                }
+                size_t firstIndex = findOrCreateTeam(index, event.team1);
+                size_t secondIndex = findOrCreateTeam(index, event.team2);
+                Team& first = teams[firstIndex];
+                Team& second = teams[secondIndex];
+                if (event.result == 'V') {
+                    first.addWin();
+                    second.addLoss();
+                } else {
+                    first.addDraw();
+                    second.addDraw();
+                }
+                update.matches++;
+
+                if (update.matches >= MATCHDAY_BATCH_SIZE || !events.tryPop(event)) {
+                    break;
+                }
+            }
+
+            if (update.matches > 0) {
+                sortTeams();
+                for (size_t i = 0; i < teams.size(); ++i) {
+                    index[teams[i].getName()] = i;
+                }
+                update.table = teams;
+            }
+            update.last = finished;
+            updates.push(std::move(update));
+        }
+    });
+
+    // Стадия вывода: отображение таблицы и задержки от получения результата до публикации
+    size_t totalMatches = 0;
+    size_t batches = 0;
+    double maxLatency = 0.0;
+    double latencySum = 0.0;
+    StandingsUpdate update;
+    do {
+        updates.pop(update);
+        if (update.matches == 0) {
+            continue;
+        }
+
+        std::cout << "\nОбновление таблицы (матчей: " << update.matches << "):\n";
+        displayTableHeader();
+        for (const auto& team : update.table) {
+            team.display();
+        }
+
+        double latency = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - update.oldestArrival).count();
+        std::cout << "Задержка обновления: " << std::fixed << std::setprecision(3) << latency << " мс\n";
+
+        totalMatches += update.matches;
+        batches++;
+        latencySum += latency;
+        maxLatency = std::max(maxLatency, latency);
+    } while (!update.last);
+
+    ingest.join();
+    ranking.join();
+
+    std::cout << "\nРежим матчдня завершен.\n";
+    std::cout << "Добавлено матчей: " << totalMatches << ", обновлений таблицы: " << batches << "\n";
+    if (batches > 0) {
+        std::cout << "Задержка обновления: средняя " << std::fixed << std::setprecision(3)
+                  << latencySum / batches << " мс, максимальная " << maxLatency << " мс\n";
+    }
+    if (invalidLines > 0) {
+        std::cout << "Пропущено некорректных строк: " << invalidLines << "\n";
+    }
+    std::cout << "Не забудьте сохранить изменения через меню.\n";
+}
+
+#ifdef ALLOCATION_COUNT_TEST
+// Функция для подсчета выделений памяти при поиске и применении результатов.
+// Первый проход прогревает структуры, выделения считаются на последующих проходах
+bool countSteadyStateAllocations(size_t& searchAllocations, size_t& applyAllocations) {
+    const int PASSES = 3;
+    searchAllocations = 0;
+    applyAllocations = 0;
+
+    for (int pass = 0; pass <= PASSES; ++pass) {
+        // Поиск: подбор похожих команд и поиск по подстроке для каждого названия
+        size_t before = allocationCount;
+        size_t matches = 0;
+        for (const auto& team : teams) {
+            auto arena = makeSearchArena();
+            matches += findSimilarTeams(team.getName(), &arena).size();
+            for (const auto& other : teams) {
+                matches += containsIgnoreCase(other.getName(), team.getName());
+            }
+        }
+        if (pass > 0) searchAllocations += allocationCount - before;
+
+        // Применение результатов и пересортировка
+        before = allocationCount;
+        for (size_t i = 0; i + 1 < teams.size(); ++i) {
+            const std::string& first = teams[i].getName();
+            const std::string& second = teams[i + 1].getName();
+            applyMatchResult(i % 2 ? 'V' : 'D', first, second);
+        }
+        sortTeams();
+        if (pass > 0) applyAllocations += allocationCount - before;
+
+        if (matches == 0) {
+            std::cout << "Поиск не нашел ни одной команды.\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Функция для проверки, что поиск и применение результатов не выделяют память в куче.
+// Проверка выполняется на загруженной таблице и на таблице, дополненной тестовыми командами
+// до размера, при котором список результатов поиска заведомо не помещается в малый буфер
+bool runAllocationTest() {
+    const size_t LARGE_TABLE_SIZE = 1000;
+
+    if (teams.size() < 2) {
+        std::cout << "Для проверки нужно минимум две команды.\n";
+        return false;
+    }
+
+    bool passed = true;
+    for (int round = 0; round < 2; ++round) {
+        if (round == 1) {
+            // Тестовые команды с уникальными названиями из английских букв (в файл не сохраняются).
+            // Название "Test Team" входит во все остальные, поэтому поиск по нему находит их все
+            teams.emplace_back("Test Team");
+            for (size_t i = 0; teams.size() < LARGE_TABLE_SIZE; ++i) {
+                std::string name = "Test Team ";
+                for (size_t n = i; ; n /= 26) {
+                    name += static_cast<char>('a' + n % 26);
+                    if (n < 26) break;
+                }
+                teams.emplace_back(name);
+            }
+        }
+
+        size_t searchAllocations, applyAllocations;
+        if (!countSteadyStateAllocations(searchAllocations, applyAllocations)) {
+            return false;
+        }
+
+        std::cout << "Команд в таблице: " << teams.size() << "\n";
+        std::cout << "Выделений памяти при поиске: " << searchAllocations << "\n";
+        std::cout << "Выделений памяти при применении результатов: " << applyAllocations << "\n";
+        passed = passed && searchAllocations == 0 && applyAllocations == 0;
+    }
+
+    std::cout << (passed ? "Проверка пройдена.\n" : "Проверка не пройдена!\n");
+    return passed;
+}
+#endif
+
 int main() {
     setRussianLocale();
     
@@ -587,6 +1569,10 @@ int main() {
         std::cout << "Не удалось загрузить базу данных. Программа будет завершена.\n";
         return 1;
     }
+
+#ifdef ALLOCATION_COUNT_TEST
+    return runAllocationTest() ? 0 : 1;
+#endif
     
     while (true) {
         std::cout << "\nМеню:\n";
@@ -598,14 +1584,17 @@ int main() {
         std::cout << "6. Удалить команду\n";
         std::cout << "7. Найти команду\n";
         std::cout << "8. Сортировать команды\n";
+        std::cout << "9. Архив сезонов\n";
+        std::cout << "10. Режим матчдня (результаты из файла или канала)\n";
+        std::cout << "11. Следить за изменениями файла базы данных\n";
         std::cout << "0. Выход\n";
         std::cout << "Выберите действие: ";
 
         int choice;
-        while (!(std::cin >> choice) || choice < 0 || choice > 8) {
+        while (!(std::cin >> choice) || choice < 0 || choice > 11) {
             std::cin.clear(); // Очищаем флаги ошибок
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Очищаем буфер
-            std::cout << "Ошибка! Введите число от 0 до 8: ";
+            std::cout << "Ошибка! Введите число от 0 до 11: ";
         }
         std::cin.ignore(); // Очищаем символ новой строки после корректного ввода
 
@@ -634,6 +1623,15 @@ int main() {
             case 8:
                 sortTeamsBy();
                 break;
+            case 9:
+                seasonArchiveMenu();
+                break;
+            case 10:
+                runMatchdayPipeline();
+                break;
+            case 11:
+                watchDatabaseFile("football_database.txt");
+                break;
             case 0:
                 std::cout << "Программа завершена.\n";
                 return 0;